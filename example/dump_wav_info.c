@@ -1,10 +1,16 @@
+#include <inttypes.h>
 #include <stdio.h>
 #include "wavdec.h"
 
+#define HASH_BUFF_SIZE  65536   // Reading buffer size for hashing audio data.
+
+static uint8_t hash_buff[HASH_BUFF_SIZE];
+
 int main(int argc, char *argv[]) {
     wav_handle_t wav_handle;
     int opterr;
     int data_rate;
+    uint64_t data_hash;
 
     if(argc < 2) {
         fprintf(stderr, "Wav file path not found!\n");
@@ -15,6 +21,11 @@ int main(int argc, char *argv[]) {
         fprintf(stderr, "Failed to initialize wav handle, opterr: %d\n", opterr);
         return -1;
     }
+    if(wavdec_hash_data(&wav_handle, hash_buff, HASH_BUFF_SIZE, &data_hash) != 0) {
+        fprintf(stderr, "Failed to hash audio data, opterr: %d\n", wavdec_get_opterr());
+        wavdec_deinit(&wav_handle);
+        return -1;
+    }
     opterr = wavdec_deinit(&wav_handle);
     if(opterr != WAVDEC_ERR_NONE) {
         fprintf(stderr, "Failed to deinitialize wav handle, opterr: %d\n", opterr);
@@ -27,6 +38,7 @@ int main(int argc, char *argv[]) {
     printf("    [Bits per sample]: %d\n", wav_handle.sample_bit);
     printf("    [Audio data rate]: %d\n", data_rate);
     printf("    [Audio data size]: %d\n", wav_handle.data_size);
+    printf("    [Audio data hash]: %016" PRIx64 "\n", data_hash);
     printf("[\"fmt \" chunk offset]: %d\n", wav_handle.offset.fmt_chunk);
     printf("[\"data\" chunk offset]: %d\n", wav_handle.offset.data_chunk);
     return 0;
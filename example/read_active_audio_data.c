@@ -0,0 +1,58 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "wavdec.h"
+
+#define RUN_CAP         256     // Capacity of active region buffer.
+#define BLOCK_TIME      20      // Analysis block time(in milliseconds).
+#define THRESHOLD       500     // RMS threshold in 16-bit sample scale.
+#define READ_FRAMES     4096    // Number of frames per reading.
+
+int main(int argc, char *argv[]) {
+    wav_handle_t wav_handle;
+    wav_activity_t activity;
+    wav_activity_run_t runs[RUN_CAP];
+    int opterr;
+    int read_frames;
+    uint32_t frame;         // Frame offset of read audio data.
+    uint8_t *buff;          // Buffer to store audio data.
+
+    if(argc < 2) {
+        fprintf(stderr, "Wav file path not found!\n");
+        return -1;
+    }
+    opterr = wavdec_init(argv[1], &wav_handle);
+    if(opterr != WAVDEC_ERR_NONE) {
+        fprintf(stderr, "Failed to initialize wav handle, opterr: %d.\n", opterr);
+        return -1;
+    }
+    buff = (uint8_t *)malloc(READ_FRAMES * wavdec_get_frame_size(&wav_handle));
+    if(buff == NULL) {
+        fprintf(stderr, "Failed to malloc memory for audio data!\n");
+        goto err_exit;
+    }
+    wavdec_init_activity(&activity, runs, RUN_CAP,
+                         wavdec_conv(&wav_handle, BLOCK_TIME, WAVDEC_CONV_MS2FRAME), THRESHOLD);
+    if(wavdec_analyze_activity(&wav_handle, &activity, buff, READ_FRAMES * wavdec_get_frame_size(&wav_handle)) != 0) {
+        fprintf(stderr, "Failed to analyze activity, opterr: %d.\n", wavdec_get_opterr());
+        goto err_exit;
+    }
+    printf("[Active regions]: %d\n", activity.run_num);
+    while((read_frames = wavdec_read_active(&wav_handle, &activity, buff, READ_FRAMES, &frame)) > 0) {
+        printf("[Read frames]: %d, [Frame offset]: %d\n", read_frames, frame);
+    }
+    if(read_frames < 0) {
+        fprintf(stderr, "Failed to read active audio data, opterr: %d.\n", wavdec_get_opterr());
+        goto err_exit;
+    }
+    free(buff);
+    opterr = wavdec_deinit(&wav_handle);
+    if(opterr != WAVDEC_ERR_NONE) {
+        fprintf(stderr, "Failed to deinitialize wav handle, opterr: %d.\n", opterr);
+        return -1;
+    }
+    return 0;
+err_exit:
+    free(buff);
+    wavdec_deinit(&wav_handle);
+    return -1;
+}
@@ -43,8 +43,8 @@ int __wavdec_fsif_seek(void *file, uint32_t offset) {
 }
 
 int __wavdec_fsif_read(void *file, void *buff, uint32_t size) {
-    size_t rsize = fread(buff, size, 1, (FILE *)file);
-    if(rsize < 0) {
+    size_t rsize = fread(buff, 1, size, (FILE *)file);
+    if(ferror((FILE *)file)) {
         wavdec_set_opterr(WAVDEC_ERR_FILE_READ_FAIL);
         return -1;
     }
@@ -4,6 +4,12 @@
 #include <string.h>
 #include "wavdec.h"
 
+#define WAVDEC_XXH64_PRIME_1        0x9E3779B185EBCA87ULL
+#define WAVDEC_XXH64_PRIME_2        0xC2B2AE3D27D4EB4FULL
+#define WAVDEC_XXH64_PRIME_3        0x165667B19E3779F9ULL
+#define WAVDEC_XXH64_PRIME_4        0x85EBCA77C2B2AE63ULL
+#define WAVDEC_XXH64_PRIME_5        0x27D4EB2F165667C5ULL
+
 static int __opterr = WAVDEC_ERR_NONE;
 
 void wavdec_set_opterr(int opterr) {
@@ -296,7 +302,7 @@ uint32_t wavdec_get_total_frames(wav_handle_t *handle) {
  * @return  Result of conversion.
  */
 uint32_t wavdec_conv(wav_handle_t *handle, uint32_t value, int code) {
-    uint32_t converted;
+    uint32_t converted = 0;
     __opterr = WAVDEC_ERR_NONE;
     switch(code) {
     case WAVDEC_CONV_MS2FRAME:
@@ -315,8 +321,8 @@ uint32_t wavdec_conv(wav_handle_t *handle, uint32_t value, int code) {
     default: {
         __opterr = WAVDEC_ERR_ILLEGAL_ARG;
     } break;
-    return converted;
     }
+    return converted;
 }
 
 /**
@@ -382,3 +388,342 @@ int wavdec_read(wav_handle_t *handle, void *buff, uint32_t size) {
     __opterr = WAVDEC_ERR_NONE;
     return read_frames;
 }
+
+/**
+ * @brief   Initialize activity index.
+ * @note    Active region buffer is provided by caller, it's filled by wavdec_analyze_activity().
+ * 
+ * @param activity      Activity index pointer.
+ * @param runs          Active region buffer pointer.
+ * @param run_cap       Capacity of active region buffer(in regions).
+ * @param block_frames  Number of frames per analysis block.
+ * @param threshold     RMS threshold in 16-bit sample scale, block is active if its RMS reaches it.
+ */
+void wavdec_init_activity(wav_activity_t *activity, wav_activity_run_t *runs, uint32_t run_cap,
+                          uint32_t block_frames, uint16_t threshold) {
+    activity->block_frames = block_frames;
+    activity->threshold = threshold;
+    activity->run_num = 0;
+    activity->run_cap = run_cap;
+    activity->cursor = 0;
+    activity->runs = runs;
+}
+
+/**
+ * @brief   Sum squares of samples, every sample is scaled to 16-bit.
+ * 
+ * @param buff        Audio data buffer pointer.
+ * @param samples     Number of samples.
+ * @param sample_bit  Bits per sample.
+ * @return  Sum of squares.
+ */
+uint64_t __wavdec_sum_squares(const uint8_t *buff, uint32_t samples, uint16_t sample_bit) {
+    uint64_t sum = 0;
+    int32_t sample;
+    uint32_t i;
+    switch(sample_bit) {
+    case 8: {
+        for(i = 0; i < samples; i++) {
+            sample = ((int32_t)buff[i] - 128) << 8;
+            sum += (uint32_t)(sample * sample);
+        }
+    } break;
+    case 16: {
+        for(i = 0; i < samples; i++, buff += 2) {
+            sample = (int16_t)((uint16_t)buff[0] | (uint16_t)buff[1] << 8);
+            sum += (uint32_t)(sample * sample);
+        }
+    } break;
+    case 24: {
+        for(i = 0; i < samples; i++, buff += 3) {
+            sample = (int32_t)((uint32_t)buff[0] << 8 | (uint32_t)buff[1] << 16 | (uint32_t)buff[2] << 24) >> 16;
+            sum += (uint32_t)(sample * sample);
+        }
+    } break;
+    case 32: {
+        for(i = 0; i < samples; i++, buff += 4) {
+            sample = (int32_t)((uint32_t)buff[0] | (uint32_t)buff[1] << 8 |
+                               (uint32_t)buff[2] << 16 | (uint32_t)buff[3] << 24) >> 16;
+            sum += (uint32_t)(sample * sample);
+        }
+    } break;
+    }
+    return sum;
+}
+
+/**
+ * @brief   Append analyzed block to activity index.
+ * 
+ * @param activity      Activity index pointer.
+ * @param block_start   First frame of block.
+ * @param block_frames  Number of frames in block.
+ * @param sum           Sum of squares of block samples.
+ * @param samples       Number of samples in block.
+ * @return  -1 is failure, 0 is success.
+ */
+int __wavdec_append_activity(wav_activity_t *activity, uint32_t block_start, uint32_t block_frames,
+                             uint64_t sum, uint64_t samples) {
+    wav_activity_run_t *run;
+    if(sum / samples < (uint64_t)activity->threshold * activity->threshold) {
+        return 0;
+    }
+    if(activity->run_num > 0) {
+        run = &activity->runs[activity->run_num - 1];
+        if(run->start_frame + run->frames == block_start) {
+            run->frames += block_frames;
+            return 0;
+        }
+    }
+    if(activity->run_num == activity->run_cap) {
+        __opterr = WAVDEC_ERR_RUN_OVERFLOW;
+        return -1;
+    }
+    run = &activity->runs[activity->run_num++];
+    run->start_frame = block_start;
+    run->frames = block_frames;
+    return 0;
+}
+
+/**
+ * @brief   Analyze audio data and build activity index.
+ * @note    Audio data is split into blocks of 'block_frames' frames, blocks whose RMS
+ *          reach the threshold are active, adjacent active blocks are merged into one region.
+ *          Audio playing progress is left unchanged.
+ * 
+ * @param handle     Handle pointer.
+ * @param activity   Activity index pointer.
+ * @param buff       Reading buffer pointer, larger buffer means fewer file reads.
+ * @param buff_size  Reading buffer size(in bytes), must hold at least one frame.
+ * @return  -1 is failure, 0 is success.
+ */
+int wavdec_analyze_activity(wav_handle_t *handle, wav_activity_t *activity, void *buff, uint32_t buff_size) {
+    uint8_t *__buff = (uint8_t *)buff;
+    uint32_t frame_size;
+    uint32_t total_frames;
+    uint32_t chunk_frames;
+    uint32_t read_frames;
+    uint32_t done_frames;
+    uint32_t block_start;
+    uint32_t block_frames;
+    uint32_t block_left;
+    uint32_t frames;
+    uint32_t i;
+    uint64_t sum;
+    int read_ret;
+    frame_size = wavdec_get_frame_size(handle);
+    if(activity->block_frames == 0 || (activity->runs == NULL && activity->run_cap != 0) ||
+       buff == NULL || buff_size < frame_size) {
+        __opterr = WAVDEC_ERR_ILLEGAL_ARG;
+        return -1;
+    }
+    activity->run_num = 0;
+    activity->cursor = 0;
+    total_frames = wavdec_get_total_frames(handle);
+    chunk_frames = buff_size / frame_size;
+    __wavdec_fsif_seek(handle->file, handle->offset.data_chunk + sizeof(wav_data_chunk_t));
+    if(__opterr != WAVDEC_ERR_NONE) {
+        return -1;
+    }
+    block_start = 0;
+    block_frames = total_frames < activity->block_frames ? total_frames : activity->block_frames;
+    block_left = block_frames;
+    sum = 0;
+    for(done_frames = 0; done_frames < total_frames; done_frames += read_frames) {
+        read_frames = total_frames - done_frames;
+        if(read_frames > chunk_frames) {
+            read_frames = chunk_frames;
+        }
+        read_ret = __wavdec_fsif_read(handle->file, __buff, read_frames * frame_size);
+        if(__opterr != WAVDEC_ERR_NONE) {
+            return -1;
+        }
+        if((uint32_t)read_ret != read_frames * frame_size) {
+            __opterr = WAVDEC_ERR_INSUFFICIENT_DATA;
+            return -1;
+        }
+        for(i = 0; i < read_frames; i += frames) {
+            frames = read_frames - i < block_left ? read_frames - i : block_left;
+            sum += __wavdec_sum_squares(&__buff[i * frame_size], frames * handle->ch_num, handle->sample_bit);
+            block_left -= frames;
+            if(block_left > 0) {
+                continue;
+            }
+            if(__wavdec_append_activity(activity, block_start, block_frames, sum,
+                                        (uint64_t)block_frames * handle->ch_num) != 0) {
+                return -1;
+            }
+            block_start += block_frames;
+            if(block_frames > total_frames - block_start) {
+                block_frames = total_frames - block_start;
+            }
+            block_left = block_frames;
+            sum = 0;
+        }
+    }
+    __opterr = WAVDEC_ERR_NONE;
+    return 0;
+}
+
+/**
+ * @brief   Read audio data of active regions only.
+ * @note    Silent blocks are skipped by seeking without reading file,
+ *          one call never reads across the end of an active region.
+ * 
+ * @param handle    Handle pointer.
+ * @param activity  Activity index pointer, built by wavdec_analyze_activity().
+ * @param buff      Data buffer pointer.
+ * @param size      Reading size(in frames), must be greater than 0.
+ * @param frame     Used to store the frame offset of the read data, can be NULL.
+ * @return  -1 is failure, 0 is no more active region, otherwise the actual reading size(in frames).
+ */
+int wavdec_read_active(wav_handle_t *handle, wav_activity_t *activity, void *buff, uint32_t size, uint32_t *frame) {
+    wav_activity_run_t *run;
+    uint32_t run_end;
+    if(size == 0) {
+        __opterr = WAVDEC_ERR_ILLEGAL_ARG;
+        return -1;
+    }
+    if(activity->cursor > activity->run_num) {
+        activity->cursor = 0;
+    }
+    if(activity->cursor > 0) {
+        run = &activity->runs[activity->cursor - 1];
+        if(handle->progress < run->start_frame + run->frames) {
+            activity->cursor = 0;
+        }
+    }
+    while(activity->cursor < activity->run_num) {
+        run = &activity->runs[activity->cursor];
+        if(handle->progress < run->start_frame + run->frames) {
+            break;
+        }
+        activity->cursor++;
+    }
+    if(activity->cursor == activity->run_num) {
+        __opterr = WAVDEC_ERR_NONE;
+        return 0;
+    }
+    run = &activity->runs[activity->cursor];
+    if(handle->progress < run->start_frame) {
+        if(wavdec_seek(handle, (int)run->start_frame, WAVDEC_SEEK_SET) != 0) {
+            __opterr = WAVDEC_ERR_FRAME_OVERFLOW;
+            return -1;
+        }
+    }
+    run_end = run->start_frame + run->frames;
+    if(size > run_end - handle->progress) {
+        size = run_end - handle->progress;
+    }
+    if(frame != NULL) {
+        *frame = handle->progress;
+    }
+    return wavdec_read(handle, buff, size);
+}
+
+uint64_t __wavdec_rotl64(uint64_t value, int bits) {
+    return (value << bits) | (value >> (64 - bits));
+}
+
+uint64_t __wavdec_load64(const uint8_t *buff) {
+    return (uint64_t)buff[0] | (uint64_t)buff[1] << 8 | (uint64_t)buff[2] << 16 | (uint64_t)buff[3] << 24 |
+           (uint64_t)buff[4] << 32 | (uint64_t)buff[5] << 40 | (uint64_t)buff[6] << 48 | (uint64_t)buff[7] << 56;
+}
+
+uint64_t __wavdec_xxh64_round(uint64_t acc, uint64_t input) {
+    acc += input * WAVDEC_XXH64_PRIME_2;
+    acc = __wavdec_rotl64(acc, 31);
+    return acc * WAVDEC_XXH64_PRIME_1;
+}
+
+uint64_t __wavdec_xxh64_merge(uint64_t acc, uint64_t value) {
+    acc ^= __wavdec_xxh64_round(0, value);
+    return acc * WAVDEC_XXH64_PRIME_1 + WAVDEC_XXH64_PRIME_4;
+}
+
+/**
+ * @brief   Hash audio data(the "data" sub-chunk payload) with XXH64, seed is 0.
+ * @note    Other sub-chunks are not hashed, so wav files with identical audio data
+ *          have identical hash. Audio playing progress is left unchanged.
+ * 
+ * @param handle     Handle pointer.
+ * @param buff       Reading buffer pointer, larger buffer means fewer file reads.
+ * @param buff_size  Reading buffer size(in bytes), must be non-zero multiple of 32.
+ * @param hash       Used to store the hash.
+ * @return  -1 is failure, 0 is success.
+ */
+int wavdec_hash_data(wav_handle_t *handle, void *buff, uint32_t buff_size, uint64_t *hash) {
+    uint8_t *__buff = (uint8_t *)buff;
+    uint64_t acc[4];
+    uint64_t h;
+    uint32_t left_size;
+    uint32_t read_size;
+    uint32_t i;
+    int read_ret;
+    if(buff == NULL || buff_size == 0 || buff_size % 32 != 0) {
+        __opterr = WAVDEC_ERR_ILLEGAL_ARG;
+        return -1;
+    }
+    acc[0] = WAVDEC_XXH64_PRIME_1 + WAVDEC_XXH64_PRIME_2;
+    acc[1] = WAVDEC_XXH64_PRIME_2;
+    acc[2] = 0;
+    acc[3] = 0 - WAVDEC_XXH64_PRIME_1;
+    __wavdec_fsif_seek(handle->file, handle->offset.data_chunk + sizeof(wav_data_chunk_t));
+    if(__opterr != WAVDEC_ERR_NONE) {
+        return -1;
+    }
+    left_size = handle->data_size;
+    while(1) {
+        read_size = left_size < buff_size ? left_size : buff_size;
+        read_ret = __wavdec_fsif_read(handle->file, __buff, read_size);
+        if(__opterr != WAVDEC_ERR_NONE) {
+            return -1;
+        }
+        if((uint32_t)read_ret != read_size) {
+            __opterr = WAVDEC_ERR_INSUFFICIENT_DATA;
+            return -1;
+        }
+        left_size -= read_size;
+        for(i = 0; i + 32 <= read_size; i += 32) {
+            acc[0] = __wavdec_xxh64_round(acc[0], __wavdec_load64(&__buff[i]));
+            acc[1] = __wavdec_xxh64_round(acc[1], __wavdec_load64(&__buff[i + 8]));
+            acc[2] = __wavdec_xxh64_round(acc[2], __wavdec_load64(&__buff[i + 16]));
+            acc[3] = __wavdec_xxh64_round(acc[3], __wavdec_load64(&__buff[i + 24]));
+        }
+        if(left_size == 0) {
+            break;
+        }
+    }
+    if(handle->data_size >= 32) {
+        h = __wavdec_rotl64(acc[0], 1) + __wavdec_rotl64(acc[1], 7) +
+            __wavdec_rotl64(acc[2], 12) + __wavdec_rotl64(acc[3], 18);
+        h = __wavdec_xxh64_merge(h, acc[0]);
+        h = __wavdec_xxh64_merge(h, acc[1]);
+        h = __wavdec_xxh64_merge(h, acc[2]);
+        h = __wavdec_xxh64_merge(h, acc[3]);
+    } else {
+        h = WAVDEC_XXH64_PRIME_5;
+    }
+    h += handle->data_size;
+    for(; i + 8 <= read_size; i += 8) {
+        h ^= __wavdec_xxh64_round(0, __wavdec_load64(&__buff[i]));
+        h = __wavdec_rotl64(h, 27) * WAVDEC_XXH64_PRIME_1 + WAVDEC_XXH64_PRIME_4;
+    }
+    if(i + 4 <= read_size) {
+        h ^= ((uint64_t)__buff[i] | (uint64_t)__buff[i + 1] << 8 |
+              (uint64_t)__buff[i + 2] << 16 | (uint64_t)__buff[i + 3] << 24) * WAVDEC_XXH64_PRIME_1;
+        h = __wavdec_rotl64(h, 23) * WAVDEC_XXH64_PRIME_2 + WAVDEC_XXH64_PRIME_3;
+        i += 4;
+    }
+    for(; i < read_size; i++) {
+        h ^= __buff[i] * WAVDEC_XXH64_PRIME_5;
+        h = __wavdec_rotl64(h, 11) * WAVDEC_XXH64_PRIME_1;
+    }
+    h ^= h >> 33;
+    h *= WAVDEC_XXH64_PRIME_2;
+    h ^= h >> 29;
+    h *= WAVDEC_XXH64_PRIME_3;
+    h ^= h >> 32;
+    *hash = h;
+    __opterr = WAVDEC_ERR_NONE;
+    return 0;
+}
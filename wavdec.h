@@ -30,6 +30,7 @@ enum {
     WAVDEC_ERR_ILLEGAL_OPT,
         WAVDEC_ERR_ILLEGAL_ARG,
         WAVDEC_ERR_FRAME_OVERFLOW,
+        WAVDEC_ERR_RUN_OVERFLOW,
 };
 
 enum {
@@ -91,6 +92,20 @@ typedef struct wav_handle {
     } offset;
 } wav_handle_t;
 
+typedef struct wav_activity_run {
+    uint32_t start_frame;       // First frame of active region.
+    uint32_t frames;            // Number of frames in active region.
+} wav_activity_run_t;
+
+typedef struct wav_activity {
+    uint32_t block_frames;      // Number of frames per analysis block.
+    uint16_t threshold;         // RMS threshold in 16-bit sample scale.
+    uint32_t run_num;           // Number of active regions.
+    uint32_t run_cap;           // Capacity of active region buffer.
+    uint32_t cursor;            // Active region index used by reading.
+    wav_activity_run_t *runs;   // Active region buffer(run-length encoded blocks).
+} wav_activity_t;
+
 typedef struct wav_riff_chunk {
     char chunk_id[4];           // String "RIFF"
     uint32_t chunk_size;        // Data size of this chunk, also include 'form_type'
@@ -137,4 +152,13 @@ int wavdec_seek(wav_handle_t *handle, int offset, int whence);
 
 int wavdec_read(wav_handle_t *handle, void *buff, uint32_t size);
 
+void wavdec_init_activity(wav_activity_t *activity, wav_activity_run_t *runs, uint32_t run_cap,
+                          uint32_t block_frames, uint16_t threshold);
+
+int wavdec_analyze_activity(wav_handle_t *handle, wav_activity_t *activity, void *buff, uint32_t buff_size);
+
+int wavdec_read_active(wav_handle_t *handle, wav_activity_t *activity, void *buff, uint32_t size, uint32_t *frame);
+
+int wavdec_hash_data(wav_handle_t *handle, void *buff, uint32_t buff_size, uint64_t *hash);
+
 #endif